@@ -1,58 +1,39 @@
-#ifndef DUMPER_H
-#define DUMPER_H
-
-#include <fstream>
-
-// enumeration type output format
-// ALL for -a, BINARY for -1, OCTAL for -2, DECIMAL for -3, HEXADECIMAL for -4
-enum OutputFormat {
-    ALL,
-    BINARY,
-    OCTAL,
-    DECIMAL,
-    HEXADECIMAL
-};
-
-extern const std::string RESET;
-extern const std::string BLACK;
-extern const std::string RED;
-extern const std::string GREEN;
-extern const std::string YELLOW;
-extern const std::string BLUE;
-extern const std::string MAGENTA;
-extern const std::string CYAN;
-extern const std::string WHITE;
-
-void printUsage(const char* programName);
-void parseCommandLineArguments(int argc, char* argv[],
-    bool& hasInputFile,
-    bool& lineShow,
-    std::string& inputFilename,
-    std::istringstream& inputStringStream,
-    bool& hasOutputFile,
-    OutputFormat& format,
-    bool& color,
-    long& linesPerScreen,
-    long& startLine,
-    long& endLine,
-    bool& onlyContent,
-    bool& hasLineRange,
-    bool& hasHelpFlag,
-    bool& isRAW,
-    std::ofstream& outputFile);
-
-void processInputFile(std::istream& inputStream,
-    bool hasOutputFile,
-    bool lineShow,
-    OutputFormat format,
-    bool color,
-    long linesPerScreen,
-    long startLine,
-    long endLine,
-    bool onlyContent,
-    bool hasLineRange,
-    bool isRAW,
-    std::ofstream& outputFile,
-    char* argv[]);
-
-#endif
+#ifndef DUMPER_H
+#define DUMPER_H
+
+#include <fstream>
+#include <iostream>
+
+#include "libdumper.h"
+
+void printUsage(const char* programName, std::ostream& out = std::cerr);
+void parseCommandLineArguments(int argc, char* argv[],
+    DumpArguments& arguments,
+    std::ofstream& outputFile);
+
+// where processInputFile reads from: a file, holes of sparse files are skipped without reading them,
+// or the string passed as argument
+struct InputSource {
+    int fd;                  // -1 for the string
+    const std::string* text;
+    bool seekHoles;          // SEEK_DATA / SEEK_HOLE can be used on fd
+    long long size;          // size of the string, or of a regular file when it was opened (-1 if unknown), never its end
+    long long offset;        // next byte to read
+    long long dataEnd;       // end of the data region offset is in, a hole (or the end of file) starts there
+};
+
+InputSource fileInput(int fd);
+InputSource stringInput(const std::string& text);
+
+void processInputFile(InputSource& input,
+    const DumpArguments& arguments,
+    std::ofstream& outputFile);
+
+// dumper --serve <socket>, only returns if the socket can't be used
+int serveDumps(const std::string& socketPath);
+
+// dumper --sniff <directory>, one line per file under directory with its format and first bytes
+// returns 1 if directory or any directory under it couldn't be read
+int sniffDirectory(const std::string& root, const DumpArguments& arguments, std::ofstream& outputFile);
+
+#endif
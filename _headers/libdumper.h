@@ -0,0 +1,114 @@
+#ifndef LIBDUMPER_H
+#define LIBDUMPER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// libdumper renders the same rows as the dumper CLI straight from memory,
+// so programs that already hold a buffer do not need to spawn the binary.
+
+// enumeration type output format
+// DUMP_ALL for -a, DUMP_BINARY for -1, DUMP_OCTAL for -2, DUMP_DECIMAL for -3, DUMP_HEXADECIMAL for -4
+// (prefixed, as the header is included by other programs)
+enum DumpFormat {
+    DUMP_ALL,
+    DUMP_BINARY,
+    DUMP_OCTAL,
+    DUMP_DECIMAL,
+    DUMP_HEXADECIMAL
+};
+
+// number of bytes shown on one row of the dump, -w changes it up to DUMP_MAX_ROW_BYTES
+const size_t DUMP_ROW_BYTES = 6;
+const size_t DUMP_MAX_ROW_BYTES = 256;
+
+// rendering options, each one mirrors the command line flag noted next to it
+struct DumpOptions {
+    DumpFormat format;   // -a, -1, -2, -3, -4
+    bool color;          // -c
+    bool isRAW;          // -0
+    bool onlyContent;    // -oc
+    bool lineShow;       // -s
+    bool hasLineRange;   // -n
+    long startLine;      // first line of -n (1 based)
+    long endLine;        // last line of -n (1 based)
+    size_t rowBytes;     // -w, between 1 and DUMP_MAX_ROW_BYTES
+    bool squeeze;        // identical rows collapse into one "*" line, -v turns it off
+
+    DumpOptions()
+        : format(DUMP_ALL), color(false), isRAW(false), onlyContent(false),
+          lineShow(false), hasLineRange(false), startLine(0), endLine(0),
+          rowBytes(DUMP_ROW_BYTES), squeeze(true) {}
+};
+
+// receives the rendered output, every row of the dump arrives in its own call ending with '\n'
+// with onlyContent the line is handed over as it is (no copy), its prefix and '\n' in separate calls
+// returning false stops the rendering
+// every function below returning bool returns false if the sink stopped it, or right away (nothing rendered)
+// if rowBytes is not between 1 and DUMP_MAX_ROW_BYTES
+typedef bool (*DumpSink)(const char* text, size_t size, void* context);
+
+// render one line (without its '\n'), lineNo is only used for the -s prefix
+bool dumpLine(const uint8_t* data, size_t size, long long lineNo,
+    const DumpOptions& options, DumpSink sink, void* context);
+
+// a line fed in pieces through dumpLinePart, so a long line (a disk image may have no '\n' at all)
+// never needs to be in memory at once
+struct DumpLineState {
+    long long lineNo;
+    unsigned long long offset;             // bytes of the line gone through so far
+    unsigned long long repeated;           // bytes of rows equal to the one above, not shown yet
+    char prefix[24];                       // "<lineNo> " with -s
+    size_t prefixSize;
+    bool hasPrevious;
+    uint8_t previous[DUMP_MAX_ROW_BYTES];  // last row shown, to collapse the identical ones after it
+    size_t pendingSize;
+    uint8_t pending[DUMP_MAX_ROW_BYTES];   // start of a row split between two pieces
+};
+
+// begin a line, then give its bytes to dumpLinePart (and its holes to dumpLineZeros) in as many pieces
+// as needed, finishDumpLine renders what is left once the line ends
+void startDumpLine(DumpLineState& state, long long lineNo, const DumpOptions& options);
+bool dumpLinePart(const uint8_t* data, size_t size,
+    const DumpOptions& options, DumpLineState& state, DumpSink sink, void* context);
+
+// count zero bytes of the line, such as a hole of a sparse file, without the caller reading them
+// with squeeze they cost one row at most, however many there are
+bool dumpLineZeros(unsigned long long count,
+    const DumpOptions& options, DumpLineState& state, DumpSink sink, void* context);
+bool finishDumpLine(const DumpOptions& options, DumpLineState& state, DumpSink sink, void* context);
+
+// render a whole buffer, it is split into lines the same way std::getline does and the -n range is honoured
+bool dumpBuffer(const uint8_t* data, size_t size,
+    const DumpOptions& options, DumpSink sink, void* context);
+
+// same as dumpBuffer but writes into a caller provided buffer
+// returns the number of bytes the whole output needs (0 if rowBytes is out of range),
+// like snprintf nothing past capacity is written
+// unlike snprintf the output is not NUL terminated
+size_t dumpToBuffer(const uint8_t* data, size_t size,
+    const DumpOptions& options, char* buffer, size_t capacity);
+
+// everything parseDumpArguments extracts from the command line flags
+struct DumpArguments {
+    DumpOptions options;
+    bool hasInputFile;          // -I
+    std::string inputFilename;
+    bool hasInputString;        // string passed as argument instead of -I
+    std::string inputString;
+    bool hasOutputFile;         // -O
+    std::string outputFilename;
+    long linesPerScreen;        // -l
+    bool hasHelpFlag;           // -h
+
+    DumpArguments()
+        : hasInputFile(false), hasInputString(false), hasOutputFile(false),
+          linesPerScreen(10), hasHelpFlag(false) {}
+};
+
+// parse the dumper command line flags, nothing is opened and the process is never exited
+// returns false and fills error with the message to show if the flags are wrong
+bool parseDumpArguments(int argc, char* argv[], DumpArguments& arguments, std::string& error);
+
+#endif
@@ -1,615 +1,313 @@
-/*
-
-# Author: prodigiousMind
-# youtube: https://www.youtube.com/c/prodigiousMind
-# github: https://github.com/prodigiousMind/
-
-Dumper is a CLI tool written in CPP to take a quick look into any type of file, it allows to view the binary, decimal, octal, hexadecimal representations of files.
-It also serves the purpose for reading a file at once, or at a specific line or range of lines.
-Moreover, it allows to write the processed data into an output file for later analysis. 
-In short, it serves the main features of commands such as cat, xxd, hexdump, more etcetera.
-
-*/
-
-#include <sstream>
-
-#include <cctype>
-
-#include <iostream>
-
-#include <iomanip>
-
-#include <bitset>
-
-#include <cstring>
-
-#include "../_headers/headerDUMP.h"
-
-// for colored output, stored in constant 
-const std::string RESET = "\033[0m";
-const std::string BLACK = "\033[30m";
-const std::string RED = "\033[31m";
-const std::string GREEN = "\033[32m";
-const std::string YELLOW = "\033[33m";
-const std::string BLUE = "\033[36m";
-const std::string MAGENTA = "\033[35m";
-const std::string CYAN = "\033[36m";
-const std::string WHITE = "\033[37m";
-
-// declaration of the function
-int checkLinePerScreen(long linesPerScreen,
-    long lineCount,
-    std::ofstream & outputFile, bool oncePassed);
-
-// show help if less arguments are passed or there is an error in command or -h flag is called in combination with any flags
-void printUsage(const char * programName) {
-    std::cerr << "Usage: " << programName << " -[I<input filename>] [-O<output filename>] [-l <lines>] [-c] [-h] [-a] [-0] [-1] [-2] [-3] [-4] [-n X|X1,X2] [-oc]\n";
-    std::cerr << "\n  -l<number>: Number of lines to output at once [Default 10]\n";
-    std::cerr << "  -c: enable colored output\n";
-    std::cerr << "  -h: display this help message\n";
-    std::cerr << "  -O: specify output file name\n";
-    std::cerr << "  -a: print all representations [default]\n";
-    std::cerr << "  -0: print content, can be used with -1/-2/-3/-4 representation\n";
-    std::cerr << "  -1: print binary representation\n";
-    std::cerr << "  -2: print octal representation\n";
-    std::cerr << "  -3: print decimal representation\n";
-    std::cerr << "  -4: print hexadecimal representation\n";
-    std::cerr << "  -n: print only line X or lines X1 to X2\n";
-    std::cerr << "  -oc: print only content without representations\n";
-}
-
-// to check whether input file is passed (-O) flag or not, so we can make use of string passed as argument for processing
-bool hasInp = false;
-
-// this function parse command line arguments, flags, and extract the values (if any) they were passed with
-void parseCommandLineArguments(int argc, char * argv[],
-    bool & hasInputFile,
-    bool & lineShow,
-    std::string & inputFilename,
-    std::istringstream & inputStringStream,
-    bool & hasOutputFile,
-    OutputFormat & format,
-    bool & color,
-    long & linesPerScreen,
-    long & startLine,
-    long & endLine, 
-    bool & onlyContent,
-    bool & hasLineRange,
-    bool & hasHelpFlag,
-    bool & isRAW,
-    std::ofstream & outputFile) {
-    if (argc > 1 && argv[1][0] != '-') {
-        inputStringStream.str(argv[1]);
-    }
-
-    // checking what flag were passed and using switch cases extracting their values
-    for (int i = 1; i < argc; i++) {
-        if (argv[i][0] == '-') {
-            
-            switch (argv[i][1]) {
-            
-            case 'I':
-                if (strlen(argv[i]) > 2) {
-                    hasInputFile = true;
-                    hasInp =true;
-                    inputFilename = argv[i] + 2;
-                } else if (i + 1 < argc && argv[i + 1][0] != '-') {
-                    hasInputFile = true;
-                    inputFilename = argv[++i];
-                    hasInp =true;
-                } else {
-                    // if it does not exists
-                    std::cerr << "Error: couldn't find input file\n";
-                    exit(1);
-                }
-                break;
-            
-            case 'O':
-                // for extracting values passed in -O flag with or without spaces next to the flag
-                if (strlen(argv[i]) > 2) {
-                    hasOutputFile = true;
-                    outputFile.open(argv[i] + 2);
-                } else if (i + 1 < argc && argv[i + 1][0] != '-') {
-                    hasOutputFile = true;
-                    outputFile.open(argv[++i]);
-                } else {
-                    // if it can't be written
-                    std::cerr << "Error: couldn't find output file name\n";
-                    exit(1);
-                }
-                if (!outputFile.is_open()) {
-                    // if there is error such as permissions and stuff
-                    std::cerr << "Error opening output file\n";
-                    exit(1);
-                }
-                break;
-            
-            case 'c':
-                // for enabling colored output
-                if (hasOutputFile) {
-                    std::cerr << "Error: -c flag cannot be used when writing to a file\n";
-                    exit(1);
-                }
-                color = true;
-                break;
-            
-            case 'l':
-                // if line (line per screen is passed)
-                if (strlen(argv[i]) > 2) {
-                    linesPerScreen = std::stoi(argv[i] + 2);
-                } else if (i + 1 < argc && argv[i + 1][0] != '-') {
-                    linesPerScreen = std::stoi(argv[++i]);
-                } else {
-                    std::cerr << "Error: couldn't find value for -l flag\n";
-                    exit(1);
-                }
-                break;
-
-            // 'a' flag for output in all (binary, hex, decimal, octal)
-            // '0' flag for content of the file, can be used with -1,-2,-3,-4
-            // '1', '2', '3', '4' for binary, octal, decimal, hexadecimal representation only 
-            case 'a':
-                format = ALL;
-                break;
-            
-            case '0':
-                isRAW = true;
-                break;
-            
-            case '1':
-                format = BINARY;
-                break;
-            
-            case '2':
-                format = OCTAL;
-                break;
-            
-            case '3':
-                format = DECIMAL;
-                break;
-            
-            case '4':
-                format = HEXADECIMAL;
-                break;
-
-            // if -n flag is passed for showing specific line(s)
-            case 'n':
-                
-                // if it is passed, boolean hasLineRange becomes true
-                // the below code extract the value, it can be in the form of -n <number> or -n <n1, n2>.
-                // for -n <number>, only "number" line will be output, otherwise from n1 to n2
-                hasLineRange = true;
-                char * value;
-                
-                if (strlen(argv[i]) > 2) {
-                    value = argv[i] + 2;
-                } else if (i + 1 < argc && argv[i + 1][0] != '-') {
-                    value = argv[++i];
-                } else {
-                    std::cerr << "Error: couldn't find value for -n flag\n";
-                    exit(1);
-                }
-                
-                // extracting startLine and endLine
-                if (strchr(value, ',')) {
-                    startLine = std::stoi(value);
-                    endLine = std::stoi(strchr(value, ',') + 1);
-                } else {
-                    startLine = endLine = std::stoi(value);
-                }
-                break;
-            
-            // if -o flag is passed and the second "-o" after this is 'c', it means, it is -oc flag, specifying that only content needs to be output
-            case 'o':
-                if (argv[i][2] == 'c') {
-                    onlyContent = true;
-                }
-                break;
-            
-            // for showing line numbers while outputting the processed data
-            case 's':
-                lineShow = true;
-                break;
-            
-            // invoke help menu
-            case 'h':
-                hasHelpFlag = true;
-            }
-       
-        } else if (!hasInputFile) {
-            inputStringStream.str(argv[i]);
-        }
-    }
-
-}
-
-// this function process stuff based on the inputFile, or string passed as argument
-void processInputFile(std::istream & inputStream,
-    bool hasOutputFile,
-    bool lineShow,
-    OutputFormat format,
-    bool color,
-    long linesPerScreen,
-    long startLine,
-    long endLine,
-    bool onlyContent,
-    bool hasLineRange,
-    bool isRAW,
-    std::ofstream & outputFile,
-    char * argv[]) {
-  
-    // long long type for large files, even though it is quite a big value
-    // lineCount holds the lines to count
-    // lineNo holds the value of current processed line, at beginning both are 0
-   
-    long long lineCount = 0;
-    long long lineNo = 0;
-    long long lineNos = 0;
-    int what = 1;
-    bool oncePassed = false; // it becomes true once one Lines per screen are printed
-    
-    // if line has range (-n present with value) and startLine is equal to endLine (only one value or equal values passed)
-    if (hasLineRange && startLine==endLine){lineNo = (long long) startLine - 1;startLine--;endLine--;}
-    if (hasLineRange && startLine < endLine){lineNo = --startLine;endLine--;}
-   
-    // string type holds the content of the line
-    std::string line;
-
-    // read while there is a line
-    while (std::getline(inputStream, line)) {
-        ++lineNos; // keep tracks of line whether lineShow enabled or not
-
-        // if (-n has value and lineCount < startLine or lineCount > endLine) then increase lineCount
-        if (hasLineRange && !oncePassed && (lineCount < startLine || lineCount > endLine)) {
-            lineCount++;
-            continue;
-        }
-
-        // if output file  is passed then out will write to file, else out will work as cout
-        std::ostream & out = outputFile.is_open() ? outputFile : std::cout;
-
-        // if lineShow is enabled, then print the decimal value of line number
-        if (lineShow) out << std::dec << ++lineNo << " ";
-
-        // if onlyContent is present
-        if (onlyContent) {
-            out << line << '\n';
-        } else {
-
-            // iterating through each character of a line in pairs of 4 at one time
-            for (int i = 0; i < line.size(); i += 6) {
-
-                // holds the respective representations
-                std::string decimalT, octalT, hexT, binT, cT;
-
-                // if lineShow is enabled and i !=  0, (not a first character of the line) as there is already a space for it
-                if (lineShow && i != 0) {
-                    std::string longString = std::to_string(lineNo);
-                    for (int x = 0; x < longString.size() + 1; x++) out << " ";
-                }
-
-                // iterating though each character in a group of 4 if there exists such
-                for (int j = i; j < i + 6 && j < line.size(); j++) {
-
-                    // char c for holding the character at a specific index 'j'
-                    char c = line[j];
-
-                    // tmp is stringstream object for holding decimal,octal,hex values of a group
-                    std::ostringstream tmp;
-                    int value = static_cast < int > (c);
-
-                    // making it 8 bit and appending the last values of the group
-                    auto binaryValue = std::bitset < 8 > (value).to_string();
-                    binT += binaryValue;
-                    
-                    // same this but with binary, here we calculated decimal from binary using stoi() and base 2
-                    int decimalValue = std::stoi(binaryValue, nullptr, 2);
-                    tmp << std::dec << std::setw(3) << std::setfill('0') << decimalValue;
-                   
-                    // the value is appended to decimalT from tmp
-                    decimalT += tmp.str();
-                   
-                    // clearing tmp to store octal value now
-                    tmp.str("");
-                    tmp.clear();
-                    tmp << std::oct << std::setw(3) << std::setfill('0') << decimalValue;
-                    octalT += tmp.str();
-                    
-                    // clearing tmp to store hex value now
-                    tmp.str("");
-                    tmp.clear();
-                   
-                    tmp << std::hex << std::setw(2) << std::setfill('0') << decimalValue;
-                    hexT += tmp.str();
-                    tmp.str("");
-                    tmp.clear();
-                   
-                    // if the character is of non-printable, then show it using '.' such as '\n' to avoid insertion of new line in output
-                    if (!isprint(c) || c == '\n' || c==' ') c = '.';
-                   
-                    tmp << std::setw(1) << std::setfill('.') << c;
-                    cT += tmp.str();
-
-
-                    // add color per octet
-                    if ((j==(i) || j==(i+2) || j==(i+4) || j==(i+6)) && color){
-                        binT += YELLOW;
-                        decimalT += YELLOW;
-                        octalT += YELLOW;
-                        hexT += YELLOW;
-                        cT += YELLOW;
-                    }else if ((j==(i+1) || j==(i+3) || j==(i+5)) && color){
-                        binT += BLUE;
-                        decimalT += BLUE;
-                        octalT += BLUE;
-                        hexT += BLUE;
-                        cT += BLUE;                  
-                    }
-                    
-                }
-                
-                // if line show is not enabled, then 6 characters will make up one line (not of the file but of the terminal), its for files having large number
-                // of characters per line
-                if (!lineShow){
-                    lineCount++;
-                    what = checkLinePerScreen(linesPerScreen, lineCount, outputFile, oncePassed);
-                    if (what == 0) return;
-                    else what = 1;
-                }
-
-                // adding spaces in case binary is less than 32 such as binary representation only of 3,2,1 character
-                // this will keep the format as it is and avoid distortion
-                while (!color && binT.size() < 48) {
-                    binT += "  ";
-                }
-                                
-                // if hex is smaller than 8 in size, appending space at last just like the above
-                while (!color && hexT.size() < 12) {
-                    hexT += " ";
-                }
-               
-                // if decimal is smaller than 9 (max 255 for 8 bit (3 digits), for 4 characters perline, it is 12 digits) in size, appending space at last just like the above
-                while (!color && decimalT.size() < 18) {
-                    decimalT += " ";
-                }
-
-                // same as decimal (3 digit max octal for 8 bit binary)
-                while (!color && octalT.size() < 18) {
-                    octalT += " ";
-                }
-
-                if (color){
-                    //bcs of adding color codes
-                    int sB=78;
-                    if (binT.size() == 13) sB = 53;
-                    if (binT.size() == 26) sB = 32+26;
-                    if (binT.size() == 39) sB = 24+39;
-                    if (binT.size() == 52) sB = 52+16;
-                    if (binT.size() == 65) sB = 8+65;
-                    while (color && binT.size() < sB) binT += " ";
-                    int sH = 42;
-                    if (hexT.size() == 7) sH = 17;
-                    if (hexT.size() == 14) sH = 8+14;
-                    if (hexT.size() == 21) sH = 6 + 21;
-                    if (hexT.size() == 28) sH = 4 + 28;
-                    if (hexT.size() == 35) sH = 2 + 35;
-                    while (color && hexT.size() < sH) hexT += " ";
-                    int sD = 48;
-                    if (decimalT.size() == 8) sD = 8+15;
-                    if (decimalT.size() == 16) sD = 16+12;
-                    if (decimalT.size() == 24) sD = 24+9;
-                    if (decimalT.size() == 32) sD = 32+6;
-                    if (decimalT.size() == 40) sD = 43;
-                    while (color && decimalT.size() < sD) decimalT += " ";
-                    while (color && octalT.size() < sD) octalT += " ";
-
-                }
-
-                // this is nothing but added to show the output in different colors (same for each character and its respective binary, octal, decimal, hex representation)
-                /*
-                    if (j==i && color){
-                        binT += GREEN;
-                        decimalT += GREEN;
-                        octalT += GREEN;
-                        hexT += GREEN;
-                        cT += GREEN;
-                    }else if (j==(i+1) && color){
-                        binT += YELLOW;
-                        decimalT += YELLOW;
-                        octalT += YELLOW;
-                        hexT += YELLOW;  
-                        cT += YELLOW;                      
-                    }else if (j==(i+2) && color){
-                        binT += MAGENTA;
-                        decimalT += MAGENTA;
-                        octalT += MAGENTA;
-                        hexT += MAGENTA;
-                        cT += MAGENTA;
-                    }else if(j==(i+3) && color){
-                        binT += BLUE;
-                        decimalT += BLUE;
-                        octalT += BLUE;
-                        hexT += BLUE; 
-                        cT += BLUE
-                    }
-                    else if(j==(i+4) && color){
-                        binT += WHITE;
-                        decimalT += WHITE;
-                        octalT += WHITE;
-                        hexT += WHITE; 
-                        cT +=  WHITE;
-                    }
-                    */
-
-                // if input and output file are specified, then write to the file
-                if (hasOutputFile && hasInp){
-                    if (onlyContent) out << cT;
-                    else{
-
-                        // use of switch case to check what to write
-                        // here no colors are added as we are writing into output file
-                        switch (format) {
-                     
-                        case ALL:
-                            out << std::left << std::setw(48);
-                            out << binT <<  " ";
-                            out << std::right << std::setw(12);
-                            out << std::hex << hexT << " ";
-                            out << std::right << std::setw(18);
-                            out << decimalT << " ";
-                            out << std::right << std::setw(18);
-                            out << octalT << " ";
-                            out << std::right << std::setw(6);
-                            out << cT << "\n";
-                            break;
-                      
-                        case BINARY:
-                            out << std::left << std::setw(48);
-                            out << binT << RESET << " ";
-                            out << std::right << std::setw(6);
-                            if (isRAW) out << cT;
-                            out << "\n";
-                            break;
-                      
-                        case OCTAL:
-                            out << std::left << std::setw(18);
-                            out <<  octalT << RESET << " ";
-                            out << std::right << std::setw(6);
-                            if (isRAW) out << cT;
-                            out << "\n";
-                            break;
-                        
-                        case DECIMAL:
-                            out << std::left << std::setw(18);
-                            out <<  decimalT << RESET << " ";
-                            out << std::right << std::setw(6);
-                            if (isRAW) out << cT;
-                            out << "\n";
-                            break;
-                        
-                        case HEXADECIMAL:
-                            out << std::left << std::setw(12);
-                            out <<  octalT << RESET << " ";
-                            out << std::right << std::setw(6);
-                            if (isRAW) out << cT;
-                            out << "\n";
-                            break;
-                        }
-                    }
-
-                    // could have been worked even without if-else, as we are doing nothing much if output file is present in the below code
-                    // but done so, in case, we implement new thing in future.
-
-                }else if (!hasOutputFile){
-                   
-                    // if no output file is passed, then output to the standard output with colors (if '-c' enabled)
-                    switch (format) {
-                   
-                    // for '-a' flag
-                    case ALL:
-                        out << std::left << std::setw(48);
-
-                        //the below commented lines are for coloring binary, hex, octal, decimal characters with different colors not per octet
-                        //if (color) out << GREEN;
-                        out << binT << RESET << " ";
-                        out << std::right << std::setw(12);
-                       // if (color) out << YELLOW;
-                        //  out<<std::hex<<std::setw(2)<<std::setfill(' ')<<hexT<<RESET<<" "; 
-                        out << std::hex << hexT << RESET << " ";
-                        out << std::right << std::setw(18);
-                       // if (color) out << MAGENTA;
-                        out << decimalT << RESET << " ";
-                        out << std::right << std::setw(18);
-                       // if (color) out << BLUE;
-                        out << octalT << RESET << " ";
-                        out << std::right << std::setw(6);
-                       // if (color) out << WHITE;
-                        out << cT << RESET << "\n";
-                        break;
-                    
-                    // for -1 flag
-                    case BINARY:
-                      //  if (color) out << GREEN;
-                        out << std::left << std::setw(48);
-                        out << binT << RESET << "    ";
-                        out << std::right << std::setw(6);
-                        if (isRAW) out << cT;
-                        out << "\n";
-                        break;
-
-                    // for -2 flag
-                    case OCTAL:
-                       // if (color) out << BLUE;
-                        out << std::left << std::setw(18);
-                        out << octalT << RESET << "    ";
-                        out << std::right << std::setw(6);
-                        if (isRAW) out << cT;
-                        out << "\n";
-                        break;
-                    
-                    // for -3 flag
-                    case DECIMAL:
-                       // if (color) out << MAGENTA;
-                        out << std::left << std::setw(18);
-                        out << decimalT << RESET << "    ";
-                        out << std::right << std::setw(6);
-                        if (isRAW) out << cT;
-                        out << "\n";
-                        break;
-                    
-                    // for -4 flag
-                    case HEXADECIMAL:
-                       // if (color) out << YELLOW;
-                        out << std::left << std::setw(12);
-                        out << hexT << RESET << "    ";
-                        out << std::right << std::setw(6);
-                        if (isRAW) out << cT;
-                        out << "\n";
-                        break;
-                    }
-                }
-            }
-        }
-
-        
-        // to get the decimal of lineNos
-        out << std::dec <<RESET;
-
-        // if range of line has been printed then break out
-        if (hasLineRange && (lineNos==endLine+1 || lineNos > endLine+1)) break;
-
-
-        // line Count is increased after reading a line
-        if (lineShow){
-            lineCount++;
-            what = checkLinePerScreen(linesPerScreen, lineCount, outputFile, oncePassed);
-            if (what == 0) return;
-            else what = 1; 
-        }
-
-    }
-}
-
-int checkLinePerScreen(long linesPerScreen,
-    long lineCount,
-    std::ofstream & outputFile, bool oncePassed){
-    // if output file is not opened, the output is writing to the standard output then to avoid filling the terminal with data print only l number of lines if passed,
-    // otherwise, only 10 lines per screen, after printing if user wants to print next 'l' number of lines, let them press enter, or else if 'q' is pressed exit the program.
-    // here press enter does not specific to pressing only enter but any key
-    if (!outputFile.is_open() && lineCount >= linesPerScreen) {
-        
-        lineCount = 0;
-        oncePassed = true;
-        std::cout << "Press any key to continue (q to exit)...";
-        char ch = std::cin.get();
-        //std::cout.flush();
-        //std::cin.ignore();
-
-        // this will put the curson in the above line at the first character and will erase whole (press continue...) line from the output
-        std::cout << "\033[A\033[2K\r" << std::flush;
-        if (ch == 'q') {
-            return 0;
-        }
-    }
-    return 1;
-}
+/*
+
+# Author: prodigiousMind
+# youtube: https://www.youtube.com/c/prodigiousMind
+# github: https://github.com/prodigiousMind/
+
+Dumper is a CLI tool written in CPP to take a quick look into any type of file, it allows to view the binary, decimal, octal, hexadecimal representations of files.
+It also serves the purpose for reading a file at once, or at a specific line or range of lines.
+Moreover, it allows to write the processed data into an output file for later analysis. 
+In short, it serves the main features of commands such as cat, xxd, hexdump, more etcetera.
+
+*/
+
+#include <cerrno>
+
+#include <cstdlib>
+
+#include <cstring>
+
+#include <iostream>
+
+#include <vector>
+
+#include <sys/stat.h>
+
+#include <unistd.h>
+
+#include "../_headers/headerDUMP.h"
+
+// declaration of the function
+int checkLinePerScreen(long linesPerScreen,
+    long lineCount,
+    std::ofstream & outputFile, bool oncePassed);
+
+// show help if less arguments are passed or there is an error in command or -h flag is called in combination with any flags
+void printUsage(const char * programName, std::ostream & out) {
+    out << "Usage: " << programName << " -[I<input filename>] [-O<output filename>] [-l <lines>] [-c] [-h] [-a] [-0] [-1] [-2] [-3] [-4] [-n X|X1,X2] [-oc] [-w <bytes>] [-v]\n";
+    out << "\n  -l<number>: Number of lines to output at once [Default 10]\n";
+    out << "  -c: enable colored output\n";
+    out << "  -h: display this help message\n";
+    out << "  -O: specify output file name\n";
+    out << "  -a: print all representations [default]\n";
+    out << "  -0: print content, can be used with -1/-2/-3/-4 representation\n";
+    out << "  -1: print binary representation\n";
+    out << "  -2: print octal representation\n";
+    out << "  -3: print decimal representation\n";
+    out << "  -4: print hexadecimal representation\n";
+    out << "  -n: print only line X or lines X1 to X2\n";
+    out << "  -oc: print only content without representations\n";
+    out << "  -w<number>: bytes shown on one row [Default 6]\n";
+    out << "  -v: show identical rows instead of collapsing them into one '* <bytes> bytes' line\n";
+    out << "  --serve <socket>: keep running and answer requests (the flags of one dump per line) on a Unix socket\n";
+    out << "  --sniff <directory>: format and first bytes of every file under directory, one line each [Default -4 -0 -w16]\n";
+}
+
+// this function parse command line arguments through libdumper, shows the error (if any) and opens the output file
+void parseCommandLineArguments(int argc, char * argv[],
+    DumpArguments & arguments,
+    std::ofstream & outputFile) {
+    std::string error;
+    if (!parseDumpArguments(argc, argv, arguments, error)) {
+        std::cerr << error << "\n";
+        exit(1);
+    }
+
+    if (arguments.hasOutputFile) {
+        outputFile.open(arguments.outputFilename);
+        if (!outputFile.is_open()) {
+            // if there is error such as permissions and stuff
+            std::cerr << "Error opening output file\n";
+            exit(1);
+        }
+    }
+}
+
+// where the rendered rows go, and what is needed to page them on the terminal
+struct OutputSink {
+    std::ostream * out;
+    std::ofstream * outputFile;
+    bool countRows; // rows are counted for paging only when -s is not passed
+    long linesPerScreen;
+    long long * lineCount;
+};
+
+// writes a row rendered by libdumper, returns false if 'q' was pressed
+static bool writeRow(const char * text, size_t size, void * context) {
+    OutputSink * sink = static_cast < OutputSink * > (context);
+
+    // if line show is not enabled, then one row makes up one line (not of the file but of the terminal), its for files having large number
+    // of characters per line
+    if (sink->countRows) {
+        ( * sink->lineCount) ++;
+        if (checkLinePerScreen(sink->linesPerScreen, * sink->lineCount, * sink->outputFile, false) == 0) return false;
+    }
+    sink->out->write(text, size);
+    return true;
+}
+
+// input read from a file, SEEK_DATA / SEEK_HOLE are tried on regular files so their holes are never read
+// files of /proc and such report a size of 0 and are simply read, the size is never taken as the end of the file
+InputSource fileInput(int fd) {
+    InputSource input = {fd, nullptr, false, -1, 0, 0};
+    struct stat info;
+    if (fstat(fd, & info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        input.size = info.st_size;
+#ifdef SEEK_DATA
+        input.seekHoles = true;
+#endif
+    }
+    return input;
+}
+
+// input taken from the string passed as argument
+InputSource stringInput(const std::string & text) {
+    InputSource input = {-1, & text, false, static_cast < long long > (text.size()), 0, 0};
+    return input;
+}
+
+// gives the next piece of input, either bytes in data and size or holeSize zero bytes the file system has no blocks for
+// returns false at the end of the input, for a file once read returns 0
+static bool nextPiece(InputSource & input, uint8_t * buffer, size_t capacity,
+    const uint8_t * & data, size_t & size, unsigned long long & holeSize) {
+    size = 0;
+    holeSize = 0;
+
+    if (input.fd < 0) {
+        if (input.offset >= input.size) return false;
+        data = reinterpret_cast < const uint8_t * > (input.text->data());
+        size = input.text->size();
+        input.offset = input.size;
+        return true;
+    }
+
+#ifdef SEEK_DATA
+    // at the end of a data region, look where the next one starts, everything before it is a hole
+    // past the size seen when the file was opened (it grew meanwhile) it is just read until read returns 0
+    if (input.seekHoles && input.offset >= input.size) input.seekHoles = false;
+    if (input.seekHoles && input.offset >= input.dataEnd) {
+        off_t dataStart = lseek(input.fd, input.offset, SEEK_DATA);
+        if (dataStart < 0 && errno == ENXIO) {
+            // only a hole is left until the size seen at open, then whatever was appended since is read
+            input.seekHoles = false;
+            if (input.offset < input.size) {
+                holeSize = input.size - input.offset;
+                input.offset = input.size;
+                lseek(input.fd, input.offset, SEEK_SET);
+                return true;
+            }
+        } else if (dataStart < 0) {
+            input.seekHoles = false; // not supported here, read everything
+        } else if (dataStart > input.offset) {
+            holeSize = dataStart - input.offset;
+            input.offset = dataStart;
+            lseek(input.fd, input.offset, SEEK_SET);
+            return true;
+        } else {
+            off_t holeStart = lseek(input.fd, input.offset, SEEK_HOLE);
+            if (holeStart > input.offset) input.dataEnd = holeStart;
+            else input.seekHoles = false;
+            lseek(input.fd, input.offset, SEEK_SET);
+        }
+    }
+#endif
+
+    if (input.seekHoles && static_cast < long long > (capacity) > input.dataEnd - input.offset) {
+        capacity = input.dataEnd - input.offset;
+    }
+    ssize_t got;
+    do {
+        got = read(input.fd, buffer, capacity);
+    } while (got < 0 && errno == EINTR);
+    if (got <= 0) return false;
+    input.offset += got;
+    data = buffer;
+    size = got;
+    return true;
+}
+
+// the line counting of processInputFile, a line begins with its first byte and ends at its '\n' or the end of input
+struct LineProgress {
+    // long long type for large files, even though it is quite a big value
+    // lineCount holds the lines to count
+    // lineNo holds the value of current processed line, at beginning both are 0
+    long long lineCount;
+    long long lineNo;
+    long long lineNos;
+    long startLine;
+    long endLine;
+    bool inLine;   // a line has begun and not ended yet
+    bool showLine; // the current line is shown, it is not skipped by -n
+    DumpLineState state;
+};
+
+static void beginLine(LineProgress & progress, const DumpOptions & options) {
+    progress.inLine = true;
+    ++progress.lineNos; // keep tracks of line whether lineShow enabled or not
+
+    // if (-n has value and lineCount < startLine or lineCount > endLine) then increase lineCount
+    progress.showLine = !(options.hasLineRange && (progress.lineCount < progress.startLine || progress.lineCount > progress.endLine));
+    if (!progress.showLine) {
+        progress.lineCount++;
+        return;
+    }
+
+    // if lineShow is enabled, then the decimal value of line number is printed before the line
+    if (options.lineShow) ++progress.lineNo;
+    startDumpLine(progress.state, progress.lineNo, options);
+}
+
+// returns false once nothing more is to be shown, 'q' was pressed or the range of lines has been printed
+static bool endLine(LineProgress & progress, const DumpArguments & arguments, OutputSink & sink, std::ofstream & outputFile) {
+    const DumpOptions & options = arguments.options;
+    progress.inLine = false;
+    if (!progress.showLine) return true;
+
+    // what is left of the rows of the line is rendered by libdumper, and written (and paged) by writeRow
+    if (!finishDumpLine(options, progress.state, writeRow, & sink)) return false;
+
+    // if range of line has been printed then break out
+    if (options.hasLineRange && progress.lineNos >= progress.endLine + 1) return false;
+
+    // line Count is increased after reading a line
+    if (options.lineShow) {
+        progress.lineCount++;
+        if (checkLinePerScreen(arguments.linesPerScreen, progress.lineCount, outputFile, false) == 0) return false;
+    }
+    return true;
+}
+
+// this function process stuff based on the inputFile, or string passed as argument
+void processInputFile(InputSource & input,
+    const DumpArguments & arguments,
+    std::ofstream & outputFile) {
+
+    const DumpOptions & options = arguments.options;
+    LineProgress progress;
+    progress.lineCount = 0;
+    progress.lineNo = 0;
+    progress.lineNos = 0;
+    progress.startLine = options.startLine;
+    progress.endLine = options.endLine;
+    progress.inLine = false;
+    progress.showLine = false;
+
+    // if line has range (-n present with value) and startLine is equal to endLine (only one value or equal values passed)
+    if (options.hasLineRange && progress.startLine == progress.endLine) {
+        progress.lineNo = (long long) progress.startLine - 1;
+        progress.startLine--;
+        progress.endLine--;
+    }
+    if (options.hasLineRange && progress.startLine < progress.endLine) {
+        progress.lineNo = --progress.startLine;
+        progress.endLine--;
+    }
+
+    // if output file  is passed then out will write to file, else out will work as cout
+    std::ostream & out = outputFile.is_open() ? outputFile : std::cout;
+    OutputSink sink = {&out, &outputFile, !options.lineShow && !options.onlyContent, arguments.linesPerScreen, &progress.lineCount};
+
+    // the input is read in chunks rather than line by line, a line may be far larger than the memory
+    std::vector < uint8_t > buffer(1 << 16);
+    const uint8_t * data;
+    size_t size;
+    unsigned long long holeSize;
+
+    while (nextPiece(input, buffer.data(), buffer.size(), data, size, holeSize)) {
+
+        // a hole is only zeros, it never ends a line
+        if (holeSize > 0) {
+            if (!progress.inLine) beginLine(progress, options);
+            if (progress.showLine && !dumpLineZeros(holeSize, options, progress.state, writeRow, &sink)) return;
+            continue;
+        }
+
+        while (size > 0) {
+            if (!progress.inLine) beginLine(progress, options);
+            const uint8_t * newline = static_cast < const uint8_t * > (memchr(data, '\n', size));
+            size_t length = newline ? newline - data : size;
+            if (progress.showLine && !dumpLinePart(data, length, options, progress.state, writeRow, &sink)) return;
+            if (!newline) break;
+            data += length + 1;
+            size -= length + 1;
+            if (!endLine(progress, arguments, sink, outputFile)) return;
+        }
+    }
+
+    // like std::getline, text after the last '\n' is a line too
+    if (progress.inLine) endLine(progress, arguments, sink, outputFile);
+}
+
+int checkLinePerScreen(long linesPerScreen,
+    long lineCount,
+    std::ofstream & outputFile, bool oncePassed){
+    // if output file is not opened, the output is writing to the standard output then to avoid filling the terminal with data print only l number of lines if passed,
+    // otherwise, only 10 lines per screen, after printing if user wants to print next 'l' number of lines, let them press enter, or else if 'q' is pressed exit the program.
+    // here press enter does not specific to pressing only enter but any key
+    if (!outputFile.is_open() && lineCount >= linesPerScreen) {
+        
+        lineCount = 0;
+        oncePassed = true;
+        std::cout << "Press any key to continue (q to exit)...";
+        char ch = std::cin.get();
+        //std::cout.flush();
+        //std::cin.ignore();
+
+        // this will put the curson in the above line at the first character and will erase whole (press continue...) line from the output
+        std::cout << "\033[A\033[2K\r" << std::flush;
+        if (ch == 'q') {
+            return 0;
+        }
+    }
+    return 1;
+}
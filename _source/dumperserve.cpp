@@ -0,0 +1,469 @@
+/*
+
+# Author: prodigiousMind
+# youtube: https://www.youtube.com/c/prodigiousMind
+# github: https://github.com/prodigiousMind/
+
+dumper --serve <socket> keeps running and answers dump requests over a Unix socket.
+A request is one line with the same flags as the command line (such as "-I /var/disk.img -n 100,120 -4 -0"),
+the answer is the dump itself, after which the connection is closed.
+Recently used files stay open, together with an index of where their lines start, so a request for a
+range of lines of a huge file does not go through the whole file again.
+Files are read with pread rather than mapped, a file truncated in the middle of an answer only cuts the answer short.
+
+*/
+
+#include <cerrno>
+
+#include <csignal>
+
+#include <cstring>
+
+#include <condition_variable>
+
+#include <deque>
+
+#include <iostream>
+
+#include <list>
+
+#include <memory>
+
+#include <mutex>
+
+#include <sstream>
+
+#include <thread>
+
+#include <vector>
+
+#include <sys/socket.h>
+
+#include <sys/stat.h>
+
+#include <sys/un.h>
+
+#include <fcntl.h>
+
+#include <unistd.h>
+
+#include "../_headers/headerDUMP.h"
+
+// files kept open at once, the least recently used one is closed first
+static const size_t CACHED_FILES = 16;
+
+// bytes read from a file at once
+static const size_t READ_BYTES = 1 << 16;
+
+// every LINE_INDEX_STEP-th line start is indexed, a lookup scans at most that many lines
+static const long long LINE_INDEX_STEP = 1024;
+
+// longest request line accepted
+static const size_t REQUEST_LIMIT = 4096;
+
+// seconds a client has to send its request before the worker gives up on it
+static const int REQUEST_TIMEOUT = 10;
+
+// seconds a client may leave the answer unread before the worker drops it
+static const int SEND_TIMEOUT = 30;
+
+// start of line 1, LINE_INDEX_STEP + 1, 2 * LINE_INDEX_STEP + 1 and so on
+// it only goes as far as the -n requests so far needed, the next one going further extends it
+struct LineIndex {
+    std::mutex lock;
+    std::vector < off_t > starts;
+    off_t scanned;      // bytes of the file gone through
+    long long lines;    // '\n' found in them
+
+    LineIndex() : scanned(0), lines(0) {
+        starts.push_back(0);
+    }
+};
+
+// a file kept open between requests
+struct CachedFile {
+    std::string path;
+    dev_t device;
+    ino_t inode;
+    off_t size;
+    time_t modified;
+    int fd;
+    std::shared_ptr < LineIndex > index;
+
+    CachedFile() : device(0), inode(0), size(0), modified(0), fd(-1) {}
+    ~CachedFile() {
+        if (fd >= 0) close(fd);
+    }
+};
+
+// recently used files, most recent first
+// a request keeps its file alive through the shared_ptr even if it is evicted meanwhile
+struct FileCache {
+    std::mutex lock;
+    std::list < std::shared_ptr < CachedFile > > files;
+};
+
+// returns the cached file of path, opening it if it is not cached or has changed since
+static std::shared_ptr < CachedFile > openCached(FileCache & cache, const std::string & path, std::string & error) {
+    struct stat info;
+    if (stat(path.c_str(), & info) != 0) {
+        error = "Error opening input file";
+        return nullptr;
+    }
+    if (!S_ISREG(info.st_mode)) {
+        error = "Error: only regular files can be dumped with --serve";
+        return nullptr;
+    }
+
+    std::lock_guard < std::mutex > guard(cache.lock);
+    std::shared_ptr < LineIndex > index;
+    for (auto file = cache.files.begin(); file != cache.files.end(); ++file) {
+        if (( * file)->path != path) continue;
+        bool sameFile = ( * file)->device == info.st_dev && ( * file)->inode == info.st_ino;
+        if (sameFile && ( * file)->size == info.st_size && ( * file)->modified == info.st_mtime) {
+            cache.files.splice(cache.files.begin(), cache.files, file);
+            return cache.files.front();
+        }
+        // the file changed, it is opened again below
+        // one that only grew (a log being written) keeps the index of the lines it already had
+        if (sameFile && info.st_size > ( * file)->size) index = ( * file)->index;
+        cache.files.erase(file);
+        break;
+    }
+
+    std::shared_ptr < CachedFile > opened = std::make_shared < CachedFile > ();
+    opened->path = path;
+    opened->device = info.st_dev;
+    opened->inode = info.st_ino;
+    opened->size = info.st_size;
+    opened->modified = info.st_mtime;
+    opened->fd = open(path.c_str(), O_RDONLY);
+    if (opened->fd < 0) {
+        error = "Error opening input file";
+        return nullptr;
+    }
+    posix_fadvise(opened->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    opened->index = index ? index : std::make_shared < LineIndex > ();
+
+    cache.files.push_front(opened);
+    if (cache.files.size() > CACHED_FILES) cache.files.pop_back();
+    return opened;
+}
+
+// reads up to READ_BYTES at offset, 0 at the end of the file (or if it can't be read any more)
+static size_t readAt(const CachedFile & file, uint8_t * buffer, off_t offset) {
+    ssize_t got;
+    do {
+        got = pread(file.fd, buffer, READ_BYTES, offset);
+    } while (got < 0 && errno == EINTR);
+    return got < 0 ? 0 : got;
+}
+
+// where the data at or after offset starts, holes of sparse files are skipped without reading them
+// -1 if only a hole is left until the size the file had when it was opened
+// past that size (or where SEEK_DATA is not supported) offset itself, the file is then just read on
+static off_t nextData(const CachedFile & file, off_t offset) {
+#ifdef SEEK_DATA
+    if (offset < file.size) {
+        off_t data = lseek(file.fd, offset, SEEK_DATA);
+        if (data >= 0) return data;
+        if (errno == ENXIO) return -1;
+    }
+#endif
+    return offset;
+}
+
+// goes on from where the index stopped until it has the start of block (or the file ends)
+// holes hold no '\n', so they are skipped
+static void extendLineIndex(const CachedFile & file, LineIndex & index, size_t block) {
+    std::vector < uint8_t > buffer(READ_BYTES);
+    while (index.starts.size() <= block) {
+        off_t offset = nextData(file, index.scanned);
+        if (offset < 0) break;
+        size_t got = readAt(file, buffer.data(), offset);
+        if (got == 0) break;
+        const uint8_t * data = buffer.data();
+        const uint8_t * end = data + got;
+        while (const void * newline = memchr(data, '\n', end - data)) {
+            data = static_cast < const uint8_t * > (newline) + 1;
+            if (++index.lines % LINE_INDEX_STEP == 0) index.starts.push_back(offset + (data - buffer.data()));
+        }
+        index.scanned = offset + got;
+    }
+}
+
+// offset where line lineNo (1 based) starts, the end of the file if it has fewer lines
+// requests for the same file wait on each other only while the index is being extended
+static off_t lineStart(CachedFile & file, long long lineNo) {
+    size_t block = (lineNo - 1) / LINE_INDEX_STEP;
+    off_t offset;
+    {
+        std::lock_guard < std::mutex > guard(file.index->lock);
+        extendLineIndex(file, * file.index, block);
+        if (block >= file.index->starts.size()) block = file.index->starts.size() - 1;
+        offset = file.index->starts[block];
+    }
+    long long line = block * LINE_INDEX_STEP + 1;
+
+    std::vector < uint8_t > buffer(READ_BYTES);
+    while (line < lineNo) {
+        off_t dataStart = nextData(file, offset);
+        if (dataStart < 0) return file.size;
+        offset = dataStart;
+        size_t got = readAt(file, buffer.data(), offset);
+        if (got == 0) break;
+        const uint8_t * data = buffer.data();
+        const uint8_t * end = data + got;
+        while (line < lineNo) {
+            const void * newline = memchr(data, '\n', end - data);
+            if (newline == nullptr) break;
+            data = static_cast < const uint8_t * > (newline) + 1;
+            line++;
+        }
+        if (line == lineNo) return offset + (data - buffer.data());
+        offset += got;
+    }
+    return offset;
+}
+
+// output of one request, written to the client in large blocks
+struct SocketSink {
+    int fd;
+    size_t size;
+    char buffer[1 << 16];
+};
+
+static bool sendAll(int fd, const char * text, size_t size) {
+    while (size > 0) {
+        ssize_t sent = write(fd, text, size);
+        if (sent < 0 && errno == EINTR) continue;
+        if (sent <= 0) return false;
+        text += sent;
+        size -= sent;
+    }
+    return true;
+}
+
+static bool flushSocket(SocketSink & sink) {
+    bool sent = sendAll(sink.fd, sink.buffer, sink.size);
+    sink.size = 0;
+    return sent;
+}
+
+// writes a row rendered by libdumper, returns false once the client went away
+static bool writeToSocket(const char * text, size_t size, void * context) {
+    SocketSink * sink = static_cast < SocketSink * > (context);
+    if (sink->size + size > sizeof(sink->buffer)) {
+        if (!flushSocket( * sink)) return false;
+        // pieces passed through by -oc can be larger than the buffer
+        if (size > sizeof(sink->buffer)) return sendAll(sink->fd, text, size);
+    }
+    memcpy(sink->buffer + sink->size, text, size);
+    sink->size += size;
+    return true;
+}
+
+static void sendText(SocketSink & sink, const std::string & text) {
+    writeToSocket(text.data(), text.size(), & sink);
+}
+
+// splits a request line into arguments at spaces, "double quotes" keep a path with spaces together
+static std::vector < std::string > splitRequest(const std::string & request) {
+    std::vector < std::string > arguments;
+    std::string argument;
+    bool quoted = false, started = false;
+    for (char c : request) {
+        if (c == '"') {
+            quoted = !quoted;
+            started = true;
+        } else if (!quoted && (c == ' ' || c == '\t' || c == '\r')) {
+            if (started) arguments.push_back(argument);
+            argument.clear();
+            started = false;
+        } else {
+            argument += c;
+            started = true;
+        }
+    }
+    if (started) arguments.push_back(argument);
+    return arguments;
+}
+
+// reads the request line, up to its '\n' (or the client closing its side)
+// a read error or the timeout drops the request, a cut "-I file -n X" must not turn into a dump of the whole file
+static bool readRequest(int client, std::string & request) {
+    char buffer[512];
+    while (request.size() < REQUEST_LIMIT) {
+        ssize_t got = read(client, buffer, sizeof(buffer));
+        if (got < 0 && errno == EINTR) continue;
+        if (got < 0) return false;
+        if (got == 0) return !request.empty();
+        const void * newline = memchr(buffer, '\n', got);
+        if (newline != nullptr) {
+            request.append(buffer, static_cast < const char * > (newline) - buffer);
+            return true;
+        }
+        request.append(buffer, got);
+    }
+    return false;
+}
+
+// renders the lines of a cached file read in pieces, with -n the line index leads straight to the first one
+// lines are split the same way dumpBuffer does, text after the last '\n' is a line only if it is not empty
+static void dumpCachedFile(CachedFile & file, const DumpOptions & options, SocketSink & sink) {
+    long long lineNo = 1;
+    off_t offset = 0;
+    if (options.hasLineRange) {
+        lineNo = options.startLine < 1 ? 1 : options.startLine;
+        offset = lineStart(file, lineNo);
+    }
+
+    std::vector < uint8_t > buffer(READ_BYTES);
+    DumpLineState state;
+    bool inLine = false;
+    for (;;) {
+        // a hole is only zeros, it never ends a line
+        off_t dataStart = nextData(file, offset);
+        if (dataStart < 0) dataStart = file.size;
+        if (dataStart > offset) {
+            if (options.hasLineRange && lineNo > options.endLine) return;
+            if (!inLine) startDumpLine(state, lineNo, options);
+            inLine = true;
+            if (!dumpLineZeros(dataStart - offset, options, state, writeToSocket, & sink)) return;
+            offset = dataStart;
+        }
+
+        size_t got = readAt(file, buffer.data(), offset);
+        if (got == 0) break;
+        offset += got;
+        const uint8_t * data = buffer.data();
+        while (got > 0) {
+            if (options.hasLineRange && lineNo > options.endLine) return;
+            if (!inLine) startDumpLine(state, lineNo, options);
+            inLine = true;
+            const uint8_t * newline = static_cast < const uint8_t * > (memchr(data, '\n', got));
+            size_t length = newline ? newline - data : got;
+            if (!dumpLinePart(data, length, options, state, writeToSocket, & sink)) return;
+            if (!newline) break;
+            data += length + 1;
+            got -= length + 1;
+            inLine = false;
+            if (!finishDumpLine(options, state, writeToSocket, & sink)) return;
+            lineNo++;
+        }
+    }
+    if (inLine) finishDumpLine(options, state, writeToSocket, & sink);
+}
+
+static void serveRequest(int client, FileCache & cache) {
+    std::unique_ptr < SocketSink > sink(new SocketSink());
+    sink->fd = client;
+    sink->size = 0;
+
+    std::string request;
+    if (!readRequest(client, request)) return;
+
+    // the request is parsed exactly like the command line, argv[0] included
+    std::vector < std::string > words = splitRequest(request);
+    std::vector < char * > argv;
+    std::string programName = "dumper";
+    argv.push_back(& programName[0]);
+    for (std::string & word : words) argv.push_back(& word[0]);
+    argv.push_back(nullptr);
+
+    DumpArguments arguments;
+    std::string error;
+    if (!parseDumpArguments(argv.size() - 1, argv.data(), arguments, error)) {
+        sendText( * sink, error + "\n");
+    } else if (arguments.hasHelpFlag) {
+        std::ostringstream usage;
+        printUsage("dumper", usage);
+        sendText( * sink, usage.str());
+    } else if (arguments.hasOutputFile) {
+        sendText( * sink, "Error: -O cannot be used with --serve\n");
+    } else if (arguments.hasInputFile) {
+        std::shared_ptr < CachedFile > file = openCached(cache, arguments.inputFilename, error);
+        if (file) {
+            dumpCachedFile( * file, arguments.options, * sink);
+        } else {
+            sendText( * sink, error + "\n");
+        }
+    } else if (arguments.hasInputString) {
+        const std::string & text = arguments.inputString;
+        dumpBuffer(reinterpret_cast < const uint8_t * > (text.data()), text.size(), arguments.options, writeToSocket, sink.get());
+    } else {
+        sendText( * sink, "No input provided\n");
+    }
+    flushSocket( * sink);
+}
+
+// clients accepted and waiting for a worker
+struct ClientQueue {
+    std::mutex lock;
+    std::condition_variable ready;
+    std::deque < int > clients;
+};
+
+static void serveWorker(ClientQueue & queue, FileCache & cache) {
+    for (;;) {
+        int client;
+        {
+            std::unique_lock < std::mutex > guard(queue.lock);
+            queue.ready.wait(guard, [ & queue] { return !queue.clients.empty(); });
+            client = queue.clients.front();
+            queue.clients.pop_front();
+        }
+        serveRequest(client, cache);
+        close(client);
+    }
+}
+
+int serveDumps(const std::string & socketPath) {
+    // a client going away in the middle of an answer must not end the server
+    signal(SIGPIPE, SIG_IGN);
+
+    struct sockaddr_un address;
+    memset( & address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Error: socket path is too long\n";
+        return 1;
+    }
+    strcpy(address.sun_path, socketPath.c_str());
+
+    // a socket left over by an earlier server is replaced, any other file is not touched
+    struct stat info;
+    if (stat(socketPath.c_str(), & info) == 0 && S_ISSOCK(info.st_mode)) unlink(socketPath.c_str());
+
+    int server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (server < 0 || bind(server, reinterpret_cast < struct sockaddr * > ( & address), sizeof(address)) != 0 || listen(server, SOMAXCONN) != 0) {
+        std::cerr << "Error: couldn't listen on " << socketPath << ": " << strerror(errno) << "\n";
+        return 1;
+    }
+
+    FileCache cache;
+    ClientQueue queue;
+    unsigned workers = std::thread::hardware_concurrency();
+    if (workers == 0) workers = 4;
+    for (unsigned i = 0; i < workers; i++) {
+        std::thread(serveWorker, std::ref(queue), std::ref(cache)).detach();
+    }
+
+    for (;;) {
+        int client = accept(server, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            std::cerr << "Error: couldn't accept on " << socketPath << ": " << strerror(errno) << "\n";
+            return 1;
+        }
+        struct timeval timeout = {REQUEST_TIMEOUT, 0};
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, & timeout, sizeof(timeout));
+        // a client that stops reading would hold its worker forever, write fails with EAGAIN instead
+        struct timeval sendTimeout = {SEND_TIMEOUT, 0};
+        setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, & sendTimeout, sizeof(sendTimeout));
+
+        std::lock_guard < std::mutex > guard(queue.lock);
+        queue.clients.push_back(client);
+        queue.ready.notify_one();
+    }
+}
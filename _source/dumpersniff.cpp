@@ -0,0 +1,331 @@
+/*
+
+# Author: prodigiousMind
+# youtube: https://www.youtube.com/c/prodigiousMind
+# github: https://github.com/prodigiousMind/
+
+dumper --sniff <directory> takes the quick look at the header and magic numbers of every file under a directory.
+Each file is read with a single pread of its first bytes, its format is named from the signature table below
+and one line per file is printed: the format, the first bytes (as -w, -1, -2, -3, -4, -0 say) and the path.
+Directories are walked by several threads at once, and the files of a directory are handed out in batches,
+so even a single flat directory has its headers read by every worker while it is still being listed.
+
+*/
+
+#include <algorithm>
+
+#include <cerrno>
+
+#include <cstring>
+
+#include <condition_variable>
+
+#include <deque>
+
+#include <iostream>
+
+#include <memory>
+
+#include <mutex>
+
+#include <thread>
+
+#include <vector>
+
+#include <dirent.h>
+
+#include <fcntl.h>
+
+#include <sys/stat.h>
+
+#include <unistd.h>
+
+#include "../_headers/headerDUMP.h"
+
+// a format recognized by its magic bytes at a given offset
+struct Signature {
+    const char * name;
+    size_t offset;
+    const char * magic;
+    size_t size;
+};
+
+// checked in order, so longer and more specific signatures come before the short ones they share bytes with
+static const Signature SIGNATURES[] = {
+    {"PNG", 0, "\x89PNG\r\n\x1a\n", 8},
+    {"SQLite", 0, "SQLite format 3\0", 16},
+    {"7z", 0, "7z\xbc\xaf\x27\x1c", 6},
+    {"xz", 0, "\xfd" "7zXZ\0", 6},
+    {"RAR", 0, "Rar!\x1a\x07", 6},
+    {"GIF", 0, "GIF87a", 6},
+    {"GIF", 0, "GIF89a", 6},
+    {"PDF", 0, "%PDF-", 5},
+    {"tar", 257, "ustar", 5},
+    {"ar", 0, "!<arch>\n", 8},
+    {"XML", 0, "<?xml", 5},
+    {"PostScript", 0, "%!PS", 4},
+    {"ELF", 0, "\x7f" "ELF", 4},
+    {"ZIP", 0, "PK\x03\x04", 4},
+    {"ZIP", 0, "PK\x05\x06", 4},
+    {"ZIP", 0, "PK\x07\x08", 4},
+    {"zstd", 0, "\x28\xb5\x2f\xfd", 4},
+    {"Mach-O", 0, "\xfe\xed\xfa\xce", 4},
+    {"Mach-O", 0, "\xfe\xed\xfa\xcf", 4},
+    {"Mach-O", 0, "\xce\xfa\xed\xfe", 4},
+    {"Mach-O", 0, "\xcf\xfa\xed\xfe", 4},
+    {"class", 0, "\xca\xfe\xba\xbe", 4},
+    {"wasm", 0, "\0asm", 4},
+    {"TIFF", 0, "II*\0", 4},
+    {"TIFF", 0, "MM\0*", 4},
+    {"Ogg", 0, "OggS", 4},
+    {"FLAC", 0, "fLaC", 4},
+    {"RIFF", 0, "RIFF", 4},
+    {"JPEG", 0, "\xff\xd8\xff", 3},
+    {"MP3", 0, "ID3", 3},
+    {"bzip2", 0, "BZh", 3},
+    {"UTF8-BOM", 0, "\xef\xbb\xbf", 3},
+    {"gzip", 0, "\x1f\x8b", 2},
+    {"PE/DOS", 0, "MZ", 2},
+    {"BMP", 0, "BM", 2},
+    {"script", 0, "#!", 2}
+};
+
+// bytes read from each file: enough for the farthest signature (tar) and for the widest row of -w
+static const size_t SNIFF_READ_BYTES = 512;
+
+// output is handed to the shared stream in blocks of whole lines
+static const size_t SNIFF_FLUSH_BYTES = 1 << 16;
+
+// width the format name is padded to
+static const size_t FORMAT_WIDTH = 10;
+
+// files of a directory handed to the other workers at once
+static const size_t SNIFF_BATCH_FILES = 256;
+
+static const char * sniffFormat(const uint8_t * data, size_t size) {
+    if (size == 0) return "empty";
+    for (const Signature & signature : SIGNATURES) {
+        if (signature.offset + signature.size <= size &&
+            memcmp(data + signature.offset, signature.magic, signature.size) == 0) return signature.name;
+    }
+
+    // nothing matched, tell text from binary data
+    for (size_t i = 0; i < size; i++) {
+        if (data[i] < 0x20 && data[i] != '\n' && data[i] != '\r' && data[i] != '\t') return "data";
+        if (data[i] == 0x7f) return "data";
+    }
+    return "text";
+}
+
+// a directory being walked, it stays open until the last batch of its files is done with it
+struct OpenDirectory {
+    int fd;
+    std::string prefix; // its path ending in '/'
+
+    OpenDirectory() : fd(-1) {}
+    ~OpenDirectory() {
+        if (fd >= 0) close(fd);
+    }
+};
+
+// names of files of one directory, sniffed by whichever worker takes them
+struct FileBatch {
+    std::shared_ptr < OpenDirectory > directory;
+    std::vector < std::string > names;
+};
+
+// directories waiting to be listed and batches of files waiting to be sniffed,
+// and how many of both are queued or being worked on, the walk is over once that count drops to 0
+struct SniffQueue {
+    std::mutex lock;
+    std::condition_variable ready;
+    std::deque < std::string > directories;
+    std::deque < FileBatch > batches;
+    size_t pending;
+    bool failed; // a directory couldn't be listed, dumper exits with 1
+};
+
+// where the lines of all workers end up
+struct SniffOutput {
+    std::mutex lock;
+    std::ostream * out;
+};
+
+static bool appendToString(const char * text, size_t size, void * context) {
+    static_cast < std::string * > (context)->append(text, size);
+    return true;
+}
+
+static void flushLines(std::string & lines, SniffOutput & output) {
+    if (lines.empty()) return;
+    std::lock_guard < std::mutex > guard(output.lock);
+    output.out->write(lines.data(), lines.size());
+    lines.clear();
+}
+
+// appends the line of one file: format, first bytes, path
+static void sniffFile(int directory, const char * name, const std::string & path,
+    const DumpOptions & options, std::string & lines) {
+    uint8_t header[SNIFF_READ_BYTES];
+    ssize_t size = -1;
+
+    // O_NONBLOCK so a file swapped for a fifo meanwhile can't hang the worker
+    int fd = openat(directory, name, O_RDONLY | O_NOCTTY | O_NONBLOCK);
+    if (fd >= 0) {
+        size = pread(fd, header, sizeof(header), 0);
+        close(fd);
+    }
+
+    const char * format = size < 0 ? "unreadable" : sniffFormat(header, size);
+    lines += format;
+    lines.append(FORMAT_WIDTH - std::min(FORMAT_WIDTH - 1, strlen(format)), ' ');
+
+    // the first bytes as one row of the dump, without its '\n'
+    size_t shown = size < 0 ? 0 : std::min(static_cast < size_t > (size), options.rowBytes);
+    if (shown > 0) {
+        dumpLine(header, shown, 0, options, appendToString, & lines);
+        lines.erase(lines.size() - 1);
+        lines += "  ";
+    }
+    lines += path;
+    lines += '\n';
+}
+
+static void sniffBatch(const FileBatch & batch, SniffOutput & output, const DumpOptions & options, std::string & lines) {
+    for (const std::string & name : batch.names) {
+        sniffFile(batch.directory->fd, name.c_str(), batch.directory->prefix + name, options, lines);
+        if (lines.size() >= SNIFF_FLUSH_BYTES) flushLines(lines, output);
+    }
+}
+
+// lists one directory, its subdirectories and every full batch of its files are queued for any worker,
+// the last few files are sniffed right away
+static void listDirectory(const std::string & path, SniffQueue & queue, SniffOutput & output,
+    const DumpOptions & options, std::string & lines) {
+    // readdir gets its own copy of the descriptor, fd stays open for the batches
+    int fd = open(path.c_str(), O_RDONLY | O_DIRECTORY);
+    int listed = fd < 0 ? -1 : dup(fd);
+    DIR * directory = listed < 0 ? nullptr : fdopendir(listed);
+    if (directory == nullptr) {
+        int error = errno;
+        if (fd >= 0) close(fd);
+        if (listed >= 0) close(listed);
+        {
+            std::lock_guard < std::mutex > guard(queue.lock);
+            queue.failed = true;
+        }
+        std::lock_guard < std::mutex > guard(output.lock);
+        std::cerr << "Error: couldn't open directory " << path << ": " << strerror(error) << "\n";
+        return;
+    }
+
+    std::shared_ptr < OpenDirectory > opened = std::make_shared < OpenDirectory > ();
+    opened->fd = fd;
+    opened->prefix = path;
+    if (opened->prefix.empty() || opened->prefix[opened->prefix.size() - 1] != '/') opened->prefix += '/';
+    FileBatch batch;
+    batch.directory = opened;
+
+    struct dirent * entry;
+    while ((entry = readdir(directory)) != nullptr) {
+        const char * name = entry->d_name;
+        if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) continue;
+
+        // symbolic links are not followed, so the walk can't loop
+        unsigned char type = entry->d_type;
+        if (type == DT_UNKNOWN) {
+            struct stat info;
+            if (fstatat(fd, name, & info, AT_SYMLINK_NOFOLLOW) != 0) continue;
+            if (S_ISDIR(info.st_mode)) type = DT_DIR;
+            else if (S_ISREG(info.st_mode)) type = DT_REG;
+        }
+
+        if (type == DT_DIR) {
+            std::lock_guard < std::mutex > guard(queue.lock);
+            queue.directories.push_back(opened->prefix + name);
+            queue.pending++;
+            queue.ready.notify_one();
+        } else if (type == DT_REG) {
+            batch.names.push_back(name);
+            if (batch.names.size() < SNIFF_BATCH_FILES) continue;
+            std::lock_guard < std::mutex > guard(queue.lock);
+            queue.batches.push_back(std::move(batch));
+            queue.pending++;
+            queue.ready.notify_one();
+            batch = FileBatch();
+            batch.directory = opened;
+        }
+    }
+    closedir(directory);
+    sniffBatch(batch, output, options, lines);
+}
+
+static void sniffWorker(SniffQueue & queue, SniffOutput & output, const DumpOptions & options) {
+    std::string lines;
+    for (;;) {
+        std::string path;
+        FileBatch batch;
+        {
+            std::unique_lock < std::mutex > guard(queue.lock);
+            queue.ready.wait(guard, [ & queue] {
+                return !queue.batches.empty() || !queue.directories.empty() || queue.pending == 0;
+            });
+            // batches go first, so directories are not kept open longer than needed
+            if (!queue.batches.empty()) {
+                batch = std::move(queue.batches.front());
+                queue.batches.pop_front();
+            } else if (!queue.directories.empty()) {
+                path = queue.directories.front();
+                queue.directories.pop_front();
+            } else {
+                break;
+            }
+        }
+
+        if (batch.directory) sniffBatch(batch, output, options, lines);
+        else listDirectory(path, queue, output, options, lines);
+
+        std::lock_guard < std::mutex > guard(queue.lock);
+        if (--queue.pending == 0) queue.ready.notify_all();
+    }
+    flushLines(lines, output);
+}
+
+int sniffDirectory(const std::string & root, const DumpArguments & arguments, std::ofstream & outputFile) {
+    // only the representation flags mean something here, every file gets exactly one row
+    DumpOptions options = arguments.options;
+    options.onlyContent = false;
+    options.lineShow = false;
+    options.squeeze = false;
+
+    SniffOutput output;
+    output.out = outputFile.is_open() ? & outputFile : & std::cout;
+
+    struct stat info;
+    if (stat(root.c_str(), & info) != 0) {
+        std::cerr << "Error: couldn't open " << root << ": " << strerror(errno) << "\n";
+        return 1;
+    }
+
+    // a single file is sniffed as it is
+    if (!S_ISDIR(info.st_mode)) {
+        std::string lines;
+        sniffFile(AT_FDCWD, root.c_str(), root, options, lines);
+        flushLines(lines, output);
+        return 0;
+    }
+
+    SniffQueue queue;
+    queue.directories.push_back(root);
+    queue.pending = 1;
+    queue.failed = false;
+
+    // reading headers mostly waits on the disk, so there are more workers than cores
+    unsigned workers = std::max(4u, 2 * std::thread::hardware_concurrency());
+    std::vector < std::thread > threads;
+    for (unsigned i = 0; i < workers; i++) {
+        threads.push_back(std::thread(sniffWorker, std::ref(queue), std::ref(output), std::cref(options)));
+    }
+    for (std::thread & thread : threads) thread.join();
+    return queue.failed ? 1 : 0;
+}
@@ -0,0 +1,630 @@
+/*
+
+# Author: prodigiousMind
+# youtube: https://www.youtube.com/c/prodigiousMind
+# github: https://github.com/prodigiousMind/
+
+libdumper holds the rendering and flag parsing part of dumper, so it can be linked into other programs.
+Rows are rendered from the caller's memory into a fixed buffer and handed to a sink, the only state kept between calls
+is the DumpLineState of a line fed in pieces, owned by the caller.
+
+*/
+
+#include <cstdio>
+
+#include <cstdlib>
+
+#include <cstring>
+
+#include "../_headers/libdumper.h"
+
+// for colored output, plain arrays so they are usable before any static constructor has run
+static const char RESET[] = "\033[0m";
+static const char YELLOW[] = "\033[33m";
+static const char BLUE[] = "\033[36m";
+
+// columns of a row, in the order -a prints them
+enum Column {
+    BINARY_COLUMN,
+    HEX_COLUMN,
+    DECIMAL_COLUMN,
+    OCTAL_COLUMN,
+    CONTENT_COLUMN,
+    COLUMN_COUNT
+};
+
+// characters one byte takes in each column
+static const size_t COLUMN_WIDTH[COLUMN_COUNT] = {8, 2, 3, 3, 1};
+
+// worst case size of one rendered row: line number prefix, five colored columns, separators
+// and 8 bytes of slack as cells are always copied 8 bytes at a time
+static const size_t DUMP_ROW_CAPACITY = 64 + DUMP_MAX_ROW_BYTES * 64;
+
+// text of every byte value in every column, computed once instead of going through bitset and stringstream per byte
+struct ByteTables {
+    char text[COLUMN_COUNT][256][8];
+
+    ByteTables() {
+        static const char digits[] = "0123456789abcdef";
+        memset(text, ' ', sizeof(text));
+        for (int value = 0; value < 256; value++) {
+            for (int bit = 0; bit < 8; bit++) {
+                text[BINARY_COLUMN][value][bit] = (value >> (7 - bit)) & 1 ? '1' : '0';
+            }
+            text[HEX_COLUMN][value][0] = digits[value >> 4];
+            text[HEX_COLUMN][value][1] = digits[value & 15];
+            text[DECIMAL_COLUMN][value][0] = digits[value / 100];
+            text[DECIMAL_COLUMN][value][1] = digits[value / 10 % 10];
+            text[DECIMAL_COLUMN][value][2] = digits[value % 10];
+            text[OCTAL_COLUMN][value][0] = digits[value >> 6];
+            text[OCTAL_COLUMN][value][1] = digits[(value >> 3) & 7];
+            text[OCTAL_COLUMN][value][2] = digits[value & 7];
+            // non-printable characters and spaces are shown as '.' to keep the row on one line
+            text[CONTENT_COLUMN][value][0] = (value > ' ' && value < 0x7f) ? static_cast<char>(value) : '.';
+        }
+    }
+};
+
+// built on first use, so rendering from another file's static constructor is safe too
+// it is looked up once per line (in rowLayout), not per cell
+static const ByteTables& byteTables() {
+    static const ByteTables tables;
+    return tables;
+}
+
+template <size_t N>
+static char* appendText(char* out, const char (&text)[N]) {
+    memcpy(out, text, N - 1);
+    return out + N - 1;
+}
+
+static char* appendSpaces(char* out, size_t count) {
+    memset(out, ' ', count);
+    return out + count;
+}
+
+// color of the cells with -c, the first byte of a row keeps the terminal color and the following ones alternate (per octet coloring)
+enum CellColor {
+    DEFAULT_COLOR,
+    YELLOW_COLOR,
+    BLUE_COLOR
+};
+
+static CellColor cellColor(size_t j) {
+    if (j == 0) return DEFAULT_COLOR;
+    return j % 2 == 1 ? YELLOW_COLOR : BLUE_COLOR;
+}
+
+// an escape code is written only when the color actually changes, padding and separators are spaces
+// so they do not care which color is active
+static char* switchColor(char* out, CellColor& current, CellColor wanted) {
+    if (current == wanted) return out;
+    current = wanted;
+    switch (wanted) {
+    case YELLOW_COLOR:
+        return appendText(out, YELLOW);
+    case BLUE_COLOR:
+        return appendText(out, BLUE);
+    default:
+        return appendText(out, RESET);
+    }
+}
+
+// one column of a row: its visible width for a full row and how it is aligned and separated
+struct ColumnLayout {
+    Column column;
+    const char (*text)[8]; // cell text of every byte value
+    size_t width;
+    bool rightAligned;
+    size_t separator; // spaces after the column
+};
+
+// the columns a format prints, worked out once per line rather than per row
+struct RowLayout {
+    ColumnLayout columns[COLUMN_COUNT];
+    size_t count;
+};
+
+static void addColumn(RowLayout& layout, Column column, size_t separator, size_t rowBytes) {
+    ColumnLayout& added = layout.columns[layout.count++];
+    added.column = column;
+    added.text = byteTables().text[column];
+    added.width = rowBytes * COLUMN_WIDTH[column];
+    added.rightAligned = column == CONTENT_COLUMN;
+    added.separator = separator;
+}
+
+static RowLayout rowLayout(const DumpOptions& options) {
+    RowLayout layout;
+    layout.count = 0;
+    switch (options.format) {
+    case DUMP_ALL:
+        addColumn(layout, BINARY_COLUMN, 1, options.rowBytes);
+        addColumn(layout, HEX_COLUMN, 1, options.rowBytes);
+        addColumn(layout, DECIMAL_COLUMN, 1, options.rowBytes);
+        addColumn(layout, OCTAL_COLUMN, 1, options.rowBytes);
+        addColumn(layout, CONTENT_COLUMN, 0, options.rowBytes);
+        return layout;
+    case DUMP_BINARY:
+        addColumn(layout, BINARY_COLUMN, 4, options.rowBytes);
+        break;
+    case DUMP_OCTAL:
+        addColumn(layout, OCTAL_COLUMN, 4, options.rowBytes);
+        break;
+    case DUMP_DECIMAL:
+        addColumn(layout, DECIMAL_COLUMN, 4, options.rowBytes);
+        break;
+    case DUMP_HEXADECIMAL:
+        addColumn(layout, HEX_COLUMN, 4, options.rowBytes);
+        break;
+    }
+
+    // -1, -2, -3, -4 print a single representation, and the content only with -0
+    if (options.isRAW) {
+        addColumn(layout, CONTENT_COLUMN, 0, options.rowBytes);
+    } else {
+        layout.columns[0].separator = 0;
+    }
+    return layout;
+}
+
+// appends count cells of one column, CellWidth is the characters a byte takes in the column
+// when Width is not 0 the row is full and count is known at compile time, so the loop can be unrolled
+template <size_t Width, size_t CellWidth>
+static char* appendCells(char* out, const uint8_t* row, size_t count, const char (*text)[8], CellColor* current) {
+    const size_t cells = Width ? Width : count;
+    if (current == nullptr) {
+        for (size_t j = 0; j < cells; j++) {
+            memcpy(out, text[row[j]], 8);
+            out += CellWidth;
+        }
+        return out;
+    }
+    for (size_t j = 0; j < cells; j++) {
+        out = switchColor(out, *current, cellColor(j));
+        memcpy(out, text[row[j]], 8);
+        out += CellWidth;
+    }
+    return out;
+}
+
+// appends the cells of one column, the plain loop is kept free of any color check
+template <size_t Width>
+static char* appendColumn(char* out, const uint8_t* row, size_t count, const ColumnLayout& layout, CellColor* current) {
+    const char (*text)[8] = layout.text;
+    switch (layout.column) {
+    case BINARY_COLUMN:
+        return appendCells<Width, 8>(out, row, count, text, current);
+    case HEX_COLUMN:
+        return appendCells<Width, 2>(out, row, count, text, current);
+    case CONTENT_COLUMN:
+        return appendCells<Width, 1>(out, row, count, text, current);
+    default:
+        return appendCells<Width, 3>(out, row, count, text, current);
+    }
+}
+
+// renders the columns of up to -w bytes followed by '\n'
+// padding comes from the visible width of the layout, escape codes never count towards it
+// a row never ends in spaces: the last column is only padded when it is right aligned
+template <size_t Width>
+static char* renderRow(char* out, const uint8_t* row, size_t count, const RowLayout& layout, bool color) {
+    CellColor current = DEFAULT_COLOR;
+    for (size_t c = 0; c < layout.count; c++) {
+        const ColumnLayout& column = layout.columns[c];
+        // a full row (Width not 0) never needs padding
+        size_t padding = Width ? 0 : column.width - count * COLUMN_WIDTH[column.column];
+        if (c + 1 == layout.count && !column.rightAligned) padding = 0;
+        if (column.rightAligned && padding > 0) out = appendSpaces(out, padding);
+        out = appendColumn<Width>(out, row, count, column, color ? &current : nullptr);
+        if (!column.rightAligned && padding > 0) out = appendSpaces(out, padding);
+        for (size_t space = 0; space < column.separator; space++) *out++ = ' ';
+    }
+    if (color) out = switchColor(out, current, DEFAULT_COLOR);
+    *out++ = '\n';
+    return out;
+}
+
+// zero bytes standing in for the holes of sparse files
+static const uint8_t ZERO_BLOCK[4096] = {};
+
+// prefix of a row: the line number on the first row of a line with -s, spaces of the same width on the others
+static char* appendPrefix(char* out, const DumpLineState& state) {
+    if (state.prefixSize == 0) return out;
+    if (state.offset == 0) {
+        memcpy(out, state.prefix, state.prefixSize);
+        return out + state.prefixSize;
+    }
+    return appendSpaces(out, state.prefixSize);
+}
+
+// rows equal to the one above are collapsed into a single "* <bytes> bytes" line, like hexdump does
+static bool flushRepeated(DumpLineState& state, DumpSink sink, void* context) {
+    if (state.repeated == 0) return true;
+    char marker[64];
+    char* out = appendPrefix(marker, state);
+    out += snprintf(out, marker + sizeof(marker) - out, "* %llu bytes\n", state.repeated);
+    state.repeated = 0;
+    return sink(marker, out - marker, context);
+}
+
+// renders full rows of one line, Width is the row width when it has a specialized kernel and 0 otherwise
+// with squeeze a row is compared with the previous one on its raw bytes, before any formatting
+template <size_t Width>
+static bool dumpFullRows(const uint8_t* data, size_t rows, const RowLayout& layout,
+    const DumpOptions& options, DumpLineState& state, DumpSink sink, void* context) {
+    const size_t rowBytes = Width ? Width : options.rowBytes;
+    const uint8_t* previous = state.hasPrevious ? state.previous : nullptr;
+    char buffer[DUMP_ROW_CAPACITY];
+    bool done = true;
+    for (size_t r = 0; r < rows; r++) {
+        const uint8_t* row = data + r * rowBytes;
+        if (options.squeeze && previous != nullptr && memcmp(previous, row, rowBytes) == 0) {
+            state.repeated += rowBytes;
+            state.offset += rowBytes;
+            continue;
+        }
+        if (!flushRepeated(state, sink, context)) {
+            done = false;
+            break;
+        }
+        char* out = appendPrefix(buffer, state);
+        out = renderRow<Width>(out, row, rowBytes, layout, options.color);
+        state.offset += rowBytes;
+        previous = row;
+        if (!sink(buffer, out - buffer, context)) {
+            done = false;
+            break;
+        }
+    }
+
+    // data belongs to the caller, the last row shown is kept for comparing the next piece
+    if (options.squeeze && previous != nullptr && previous != state.previous) {
+        memcpy(state.previous, previous, rowBytes);
+        state.hasPrevious = true;
+    }
+    return done;
+}
+
+// the usual row widths have their own kernels
+static bool dumpFullRowsFor(const uint8_t* data, size_t rows, const RowLayout& layout,
+    const DumpOptions& options, DumpLineState& state, DumpSink sink, void* context) {
+    switch (options.rowBytes) {
+    case 6:
+        return dumpFullRows<6>(data, rows, layout, options, state, sink, context);
+    case 8:
+        return dumpFullRows<8>(data, rows, layout, options, state, sink, context);
+    case 16:
+        return dumpFullRows<16>(data, rows, layout, options, state, sink, context);
+    case 32:
+        return dumpFullRows<32>(data, rows, layout, options, state, sink, context);
+    case 64:
+        return dumpFullRows<64>(data, rows, layout, options, state, sink, context);
+    default:
+        return dumpFullRows<0>(data, rows, layout, options, state, sink, context);
+    }
+}
+
+// rows wider than DUMP_MAX_ROW_BYTES would overflow the row buffers, and rowBytes 0 has no rows at all
+static bool validRowBytes(const DumpOptions& options) {
+    return options.rowBytes >= 1 && options.rowBytes <= DUMP_MAX_ROW_BYTES;
+}
+
+void startDumpLine(DumpLineState& state, long long lineNo, const DumpOptions& options) {
+    state.lineNo = lineNo;
+    state.offset = 0;
+    state.repeated = 0;
+    state.hasPrevious = false;
+    state.pendingSize = 0;
+
+    // line number shown with -s, the following rows of the same line are indented by its width
+    state.prefixSize = 0;
+    if (options.lineShow) state.prefixSize = snprintf(state.prefix, sizeof(state.prefix), "%lld ", lineNo);
+}
+
+bool dumpLinePart(const uint8_t* data, size_t size,
+    const DumpOptions& options, DumpLineState& state, DumpSink sink, void* context) {
+    if (!validRowBytes(options)) return false;
+    if (size == 0) return true;
+
+    // -oc passes the line through as it is
+    if (options.onlyContent) {
+        if (state.offset == 0 && state.prefixSize > 0 && !sink(state.prefix, state.prefixSize, context)) return false;
+        state.offset += size;
+        return sink(reinterpret_cast<const char*>(data), size, context);
+    }
+
+    RowLayout layout = rowLayout(options);
+    const size_t rowBytes = options.rowBytes;
+
+    // a row split over the previous piece is completed first
+    if (state.pendingSize > 0) {
+        size_t taken = rowBytes - state.pendingSize < size ? rowBytes - state.pendingSize : size;
+        memcpy(state.pending + state.pendingSize, data, taken);
+        state.pendingSize += taken;
+        data += taken;
+        size -= taken;
+        if (state.pendingSize < rowBytes) return true;
+        state.pendingSize = 0;
+        if (!dumpFullRowsFor(state.pending, 1, layout, options, state, sink, context)) return false;
+    }
+
+    // full rows are rendered straight from data, the rest waits for the next piece or finishDumpLine
+    size_t rows = size / rowBytes;
+    if (rows > 0 && !dumpFullRowsFor(data, rows, layout, options, state, sink, context)) return false;
+    state.pendingSize = size - rows * rowBytes;
+    memcpy(state.pending, data + rows * rowBytes, state.pendingSize);
+    return true;
+}
+
+bool dumpLineZeros(unsigned long long count,
+    const DumpOptions& options, DumpLineState& state, DumpSink sink, void* context) {
+    if (!validRowBytes(options)) return false;
+    const size_t rowBytes = options.rowBytes;
+
+    // the row started before the zeros (if any) is filled up first
+    if (!options.onlyContent && state.pendingSize > 0) {
+        size_t taken = rowBytes - state.pendingSize < count ? rowBytes - state.pendingSize : count;
+        if (!dumpLinePart(ZERO_BLOCK, taken, options, state, sink, context)) return false;
+        count -= taken;
+    }
+
+    // with squeeze only the first zero row can show up, the others repeat it and are just counted
+    if (!options.onlyContent && options.squeeze && count >= rowBytes) {
+        RowLayout layout = rowLayout(options);
+        unsigned long long rows = count / rowBytes;
+        if (!dumpFullRowsFor(ZERO_BLOCK, 1, layout, options, state, sink, context)) return false;
+        state.repeated += (rows - 1) * rowBytes;
+        state.offset += (rows - 1) * rowBytes;
+        count -= rows * rowBytes;
+    }
+
+    while (count > 0) {
+        size_t size = count < sizeof(ZERO_BLOCK) ? count : sizeof(ZERO_BLOCK);
+        if (!dumpLinePart(ZERO_BLOCK, size, options, state, sink, context)) return false;
+        count -= size;
+    }
+    return true;
+}
+
+bool finishDumpLine(const DumpOptions& options, DumpLineState& state, DumpSink sink, void* context) {
+    if (!validRowBytes(options)) return false;
+    if (options.onlyContent) {
+        if (state.offset == 0 && state.prefixSize > 0 && !sink(state.prefix, state.prefixSize, context)) return false;
+        return sink("\n", 1, context);
+    }
+
+    if (!flushRepeated(state, sink, context)) return false;
+
+    // the last row of a line can be short, it always goes through the generic kernel
+    if (state.pendingSize > 0) {
+        RowLayout layout = rowLayout(options);
+        char buffer[DUMP_ROW_CAPACITY];
+        char* out = appendPrefix(buffer, state);
+        out = renderRow<0>(out, state.pending, state.pendingSize, layout, options.color);
+        state.offset += state.pendingSize;
+        state.pendingSize = 0;
+        return sink(buffer, out - buffer, context);
+    }
+
+    // an empty line has no rows, only its number is shown with -s
+    if (state.offset == 0 && state.prefixSize > 0) {
+        char line[sizeof(state.prefix) + 1];
+        memcpy(line, state.prefix, state.prefixSize);
+        line[state.prefixSize] = '\n';
+        return sink(line, state.prefixSize + 1, context);
+    }
+    return true;
+}
+
+bool dumpLine(const uint8_t* data, size_t size, long long lineNo,
+    const DumpOptions& options, DumpSink sink, void* context) {
+    DumpLineState state;
+    startDumpLine(state, lineNo, options);
+    return dumpLinePart(data, size, options, state, sink, context)
+        && finishDumpLine(options, state, sink, context);
+}
+
+bool dumpBuffer(const uint8_t* data, size_t size,
+    const DumpOptions& options, DumpSink sink, void* context) {
+    if (!validRowBytes(options)) return false;
+    long long lineNo = 0;
+    size_t start = 0;
+
+    // like std::getline, text after the last '\n' is a line only if it is not empty
+    while (start < size) {
+        const void* newline = memchr(data + start, '\n', size - start);
+        size_t length = newline ? static_cast<const uint8_t*>(newline) - (data + start) : size - start;
+        ++lineNo;
+        if (options.hasLineRange && lineNo > options.endLine) break;
+        if (!options.hasLineRange || lineNo >= options.startLine) {
+            if (!dumpLine(data + start, length, lineNo, options, sink, context)) return false;
+        }
+        start += length + 1;
+    }
+    return true;
+}
+
+// where dumpToBuffer is writing, size keeps counting after capacity is reached
+struct BufferSink {
+    char* buffer;
+    size_t capacity;
+    size_t size;
+};
+
+static bool writeToBuffer(const char* text, size_t size, void* context) {
+    BufferSink* target = static_cast<BufferSink*>(context);
+    if (target->size < target->capacity) {
+        size_t room = target->capacity - target->size;
+        memcpy(target->buffer + target->size, text, size < room ? size : room);
+    }
+    target->size += size;
+    return true;
+}
+
+size_t dumpToBuffer(const uint8_t* data, size_t size,
+    const DumpOptions& options, char* buffer, size_t capacity) {
+    BufferSink target = {buffer, capacity, 0};
+    dumpBuffer(data, size, options, writeToBuffer, &target);
+    return target.size;
+}
+
+// value of a flag passed either as -X<value> or -X <value>
+static bool flagValue(int argc, char* argv[], int& i, const char*& value) {
+    if (strlen(argv[i]) > 2) {
+        value = argv[i] + 2;
+    } else if (i + 1 < argc && argv[i + 1][0] != '-') {
+        value = argv[++i];
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// leading number of text, anything after it (such as ",X2" of -n) is left for the caller
+// unless whole is set, then text must be the number and nothing else
+static bool numberValue(const char* text, long& number, bool whole = false) {
+    char* end;
+    number = strtol(text, &end, 10);
+    return end != text && (!whole || *end == '\0');
+}
+
+bool parseDumpArguments(int argc, char* argv[], DumpArguments& arguments, std::string& error) {
+    DumpOptions& options = arguments.options;
+    const char* value;
+
+    // checking what flag were passed and using switch cases extracting their values
+    for (int i = 1; i < argc; i++) {
+        if (argv[i][0] == '-') {
+
+            switch (argv[i][1]) {
+
+            case 'I':
+                if (!flagValue(argc, argv, i, value)) {
+                    error = "Error: couldn't find input file";
+                    return false;
+                }
+                arguments.hasInputFile = true;
+                arguments.inputFilename = value;
+                break;
+
+            case 'O':
+                // the file itself is opened by the caller
+                if (!flagValue(argc, argv, i, value)) {
+                    error = "Error: couldn't find output file name";
+                    return false;
+                }
+                arguments.hasOutputFile = true;
+                arguments.outputFilename = value;
+                break;
+
+            case 'c':
+                // for enabling colored output
+                if (arguments.hasOutputFile) {
+                    error = "Error: -c flag cannot be used when writing to a file";
+                    return false;
+                }
+                options.color = true;
+                break;
+
+            case 'l':
+                // if line (line per screen is passed)
+                if (!flagValue(argc, argv, i, value)) {
+                    error = "Error: couldn't find value for -l flag";
+                    return false;
+                }
+                if (!numberValue(value, arguments.linesPerScreen)) {
+                    error = "Error: invalid value for -l flag";
+                    return false;
+                }
+                break;
+
+            // -w <number>, bytes shown on one row
+            case 'w':
+                if (!flagValue(argc, argv, i, value)) {
+                    error = "Error: couldn't find value for -w flag";
+                    return false;
+                }
+                long rowBytes;
+                if (!numberValue(value, rowBytes, true) || rowBytes < 1 || rowBytes > static_cast<long>(DUMP_MAX_ROW_BYTES)) {
+                    error = "Error: -w flag takes a number of bytes from 1 to " + std::to_string(DUMP_MAX_ROW_BYTES);
+                    return false;
+                }
+                options.rowBytes = rowBytes;
+                break;
+
+            // -v shows every row, identical ones are not collapsed
+            case 'v':
+                options.squeeze = false;
+                break;
+
+            // 'a' flag for output in all (binary, hex, decimal, octal)
+            // '0' flag for content of the file, can be used with -1,-2,-3,-4
+            // '1', '2', '3', '4' for binary, octal, decimal, hexadecimal representation only
+            case 'a':
+                options.format = DUMP_ALL;
+                break;
+
+            case '0':
+                options.isRAW = true;
+                break;
+
+            case '1':
+                options.format = DUMP_BINARY;
+                break;
+
+            case '2':
+                options.format = DUMP_OCTAL;
+                break;
+
+            case '3':
+                options.format = DUMP_DECIMAL;
+                break;
+
+            case '4':
+                options.format = DUMP_HEXADECIMAL;
+                break;
+
+            // -n <number> shows only that line, -n <n1,n2> lines n1 to n2
+            case 'n':
+                if (!flagValue(argc, argv, i, value)) {
+                    error = "Error: couldn't find value for -n flag";
+                    return false;
+                }
+                if (!numberValue(value, options.startLine)) {
+                    error = "Error: invalid value for -n flag";
+                    return false;
+                }
+                options.endLine = options.startLine;
+                if (strchr(value, ',') && !numberValue(strchr(value, ',') + 1, options.endLine)) {
+                    error = "Error: invalid value for -n flag";
+                    return false;
+                }
+                options.hasLineRange = true;
+                break;
+
+            // -oc, only content needs to be output
+            case 'o':
+                if (argv[i][2] == 'c') {
+                    options.onlyContent = true;
+                }
+                break;
+
+            // for showing line numbers while outputting the processed data
+            case 's':
+                options.lineShow = true;
+                break;
+
+            // invoke help menu
+            case 'h':
+                arguments.hasHelpFlag = true;
+            }
+
+        } else if (!arguments.hasInputFile) {
+            // no -I (yet), the argument itself is the input
+            arguments.hasInputString = true;
+            arguments.inputString = argv[i];
+        }
+    }
+    return true;
+}